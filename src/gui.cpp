@@ -36,6 +36,38 @@ void main() {
 }
 )";
 
+const std::string PackedVertexSource = R"(
+#version 120
+
+uniform mat4 matrix;
+uniform vec3 boundsMin;
+uniform vec3 boundsSize;
+
+attribute vec3 position;
+attribute vec2 normal;
+attribute float value;
+
+varying vec3 ec_pos;
+varying vec3 ec_normal;
+varying float ec_value;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        vec2 s = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * s;
+    }
+    return normalize(n);
+}
+
+void main() {
+    gl_Position = matrix * vec4(boundsMin + position * boundsSize, 1);
+    ec_pos = vec3(gl_Position);
+    ec_normal = octDecode(normal);
+    ec_value = value;
+}
+)";
+
 const std::string FragmentSource = R"(
 #version 120
 
@@ -61,6 +93,13 @@ void main() {
 }
 )";
 
+// upload 12 byte PackedVertex data instead of 28 bytes of floats per vertex
+const bool UsePackedVertices = true;
+
+// print average upload sizes and times every StatsInterval frames
+const bool PrintUploadStats = false;
+const int StatsInterval = 100;
+
 void RunGUI(Model &model) {
     auto startTime = std::chrono::steady_clock::now();
     std::chrono::duration<double> elapsed;
@@ -92,12 +131,16 @@ void RunGUI(Model &model) {
     glCullFace(GL_BACK);
     glClearColor((float)0x2a/255, (float)0x2c/255, (float)0x2b/255, 1);
 
-    Program program(VertexSource, FragmentSource);
+    Program program(
+        UsePackedVertices ? PackedVertexSource : VertexSource,
+        FragmentSource);
 
     const auto positionAttrib = program.GetAttribLocation("position");
     const auto normalAttrib = program.GetAttribLocation("normal");
     const auto valueAttrib = program.GetAttribLocation("value");
     const auto matrixUniform = program.GetUniformLocation("matrix");
+    const auto boundsMinUniform = program.GetUniformLocation("boundsMin");
+    const auto boundsSizeUniform = program.GetUniformLocation("boundsSize");
 
     GLuint arrayBuffer;
     GLuint elementBuffer;
@@ -129,40 +172,64 @@ void RunGUI(Model &model) {
     };
 
     std::vector<float> vertexAttributes;
+    std::vector<PackedVertex> packedVertices;
     std::vector<glm::uvec3> indexes;
-
-    const auto updateBuffers = [&]() {
-        vertexAttributes.resize(0);
-        model.VertexAttributes(vertexAttributes);
-
-        indexes.resize(0);
-        model.TriangleIndexes(indexes);
+    glm::vec3 boundsMin, boundsMax;
+
+    const auto updateVertexBuffer = [&]() {
+        const void *vertexData;
+        size_t vertexBytes;
+        if (UsePackedVertices) {
+            model.PackedVertexAttributes(packedVertices, boundsMin, boundsMax);
+            vertexData = packedVertices.data();
+            vertexBytes = packedVertices.size() * sizeof(PackedVertex);
+        } else {
+            vertexAttributes.resize(0);
+            model.VertexAttributes(vertexAttributes);
+            vertexData = vertexAttributes.data();
+            vertexBytes = vertexAttributes.size() * sizeof(float);
+        }
 
         glBindBuffer(GL_ARRAY_BUFFER, arrayBuffer);
         glBufferData(
-            GL_ARRAY_BUFFER,
-            vertexAttributes.size() * sizeof(vertexAttributes.front()),
-            vertexAttributes.data(),
-            GL_DYNAMIC_DRAW);
+            GL_ARRAY_BUFFER, vertexBytes, vertexData, GL_DYNAMIC_DRAW);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+        return vertexBytes;
+    };
+
+    const auto updateIndexBuffer = [&]() {
+        indexes.resize(0);
+        model.TriangleIndexes(indexes);
+
+        const size_t indexBytes = indexes.size() * sizeof(glm::uvec3);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
         glBufferData(
-            GL_ELEMENT_ARRAY_BUFFER,
-            indexes.size() * sizeof(indexes.front()),
-            indexes.data(),
+            GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexes.data(),
             GL_DYNAMIC_DRAW);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        return indexBytes;
     };
 
+    int statsFrames = 0;
+    size_t statsVertexBytes = 0;
+    size_t statsIndexBytes = 0;
+    std::chrono::duration<double> statsVertexTime(0);
+    std::chrono::duration<double> statsFrameTime(0);
+
     while (!glfwWindowShouldClose(window)) {
-        elapsed = std::chrono::steady_clock::now() - startTime;
+        const auto frameStartTime = std::chrono::steady_clock::now();
+        elapsed = frameStartTime - startTime;
 
         for (int i = 0; i < 1; i++) {
             model.Update(pool);
         }
 
-        updateBuffers();
+        const auto vertexStartTime = std::chrono::steady_clock::now();
+        statsVertexBytes += updateVertexBuffer();
+        statsVertexTime += std::chrono::steady_clock::now() - vertexStartTime;
+        statsIndexBytes += updateIndexBuffer();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -188,9 +255,18 @@ void RunGUI(Model &model) {
         glEnableVertexAttribArray(positionAttrib);
         glEnableVertexAttribArray(normalAttrib);
         glEnableVertexAttribArray(valueAttrib);
-        glVertexAttribPointer(positionAttrib, 3, GL_FLOAT, false, 28, 0);
-        glVertexAttribPointer(normalAttrib, 3, GL_FLOAT, false, 28, (void *)12);
-        glVertexAttribPointer(valueAttrib, 1, GL_FLOAT, false, 28, (void *)24);
+        if (UsePackedVertices) {
+            const glm::vec3 boundsSize = boundsMax - boundsMin;
+            glUniform3fv(boundsMinUniform, 1, glm::value_ptr(boundsMin));
+            glUniform3fv(boundsSizeUniform, 1, glm::value_ptr(boundsSize));
+            glVertexAttribPointer(positionAttrib, 3, GL_UNSIGNED_SHORT, true, 12, 0);
+            glVertexAttribPointer(normalAttrib, 2, GL_BYTE, true, 12, (void *)8);
+            glVertexAttribPointer(valueAttrib, 1, GL_UNSIGNED_BYTE, true, 12, (void *)10);
+        } else {
+            glVertexAttribPointer(positionAttrib, 3, GL_FLOAT, false, 28, 0);
+            glVertexAttribPointer(normalAttrib, 3, GL_FLOAT, false, 28, (void *)12);
+            glVertexAttribPointer(valueAttrib, 1, GL_FLOAT, false, 28, (void *)24);
+        }
         glDrawElements(GL_TRIANGLES, indexes.size() * 3, GL_UNSIGNED_INT, 0);
         glDisableVertexAttribArray(positionAttrib);
         glDisableVertexAttribArray(normalAttrib);
@@ -200,6 +276,26 @@ void RunGUI(Model &model) {
 
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        statsFrameTime += std::chrono::steady_clock::now() - frameStartTime;
+        statsFrames++;
+        if (PrintUploadStats && statsFrames == StatsInterval) {
+            std::cerr
+                << (UsePackedVertices ? "packed" : "float") << " vertices: "
+                << statsVertexBytes / statsFrames / 1024 << " KiB/frame, "
+                << statsVertexTime.count() * 1000 / statsFrames << "ms pack + upload; "
+                << "indexes: "
+                << statsIndexBytes / statsFrames / 1024 << " KiB/frame; "
+                << statsFrameTime.count() * 1000 / statsFrames << "ms frame"
+                << std::endl;
+        }
+        if (statsFrames == StatsInterval) {
+            statsFrames = 0;
+            statsVertexBytes = 0;
+            statsIndexBytes = 0;
+            statsVertexTime = std::chrono::duration<double>(0);
+            statsFrameTime = std::chrono::duration<double>(0);
+        }
     }
 
     glfwTerminate();
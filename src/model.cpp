@@ -5,6 +5,8 @@
 #include <glm/gtx/hash.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/normal.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <unordered_map>
 
@@ -366,6 +368,69 @@ void Model::TriangleIndexes(std::vector<glm::uvec3> &result) const {
     }
 }
 
+namespace {
+
+// octEncode maps a unit vector onto the [-1, 1] square using the
+// octahedral projection
+glm::vec2 octEncode(const glm::vec3 &n) {
+    const float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (sum == 0) {
+        return glm::vec2(0);
+    }
+    glm::vec2 p = glm::vec2(n.x, n.y) / sum;
+    if (n.z < 0) {
+        const float sx = p.x >= 0 ? 1 : -1;
+        const float sy = p.y >= 0 ? 1 : -1;
+        p = glm::vec2(
+            (1 - std::abs(p.y)) * sx,
+            (1 - std::abs(p.x)) * sy);
+    }
+    return p;
+}
+
+// GL 2.1 decodes normalized GL_BYTE as (2c + 1) / 255
+int8_t quantizeSigned8(const float x) {
+    const float c = std::round((x * 255 - 1) / 2);
+    return std::max(-128.f, std::min(127.f, c));
+}
+
+uint8_t quantizeUnsigned8(const float x) {
+    return std::round(std::max(0.f, std::min(1.f, x)) * 255);
+}
+
+uint16_t quantizeUnsigned16(const float x) {
+    return std::round(std::max(0.f, std::min(1.f, x)) * 65535);
+}
+
+}
+
+void Model::PackedVertexAttributes(
+    std::vector<PackedVertex> &result,
+    glm::vec3 &min, glm::vec3 &max) const
+{
+    Bounds(min, max);
+    const glm::vec3 size = max - min;
+    const glm::vec3 scale(
+        size.x > 0 ? 1 / size.x : 0,
+        size.y > 0 ? 1 / size.y : 0,
+        size.z > 0 ? 1 / size.z : 0);
+    result.resize(m_Positions.size());
+    for (int i = 0; i < m_Positions.size(); i++) {
+        const glm::vec3 p = (m_Positions[i] - min) * scale;
+        const glm::vec2 n = octEncode(m_Normals[i]);
+        const float value = m_Food[i] / m_SplitThreshold;
+        PackedVertex &v = result[i];
+        v.Position[0] = quantizeUnsigned16(p.x);
+        v.Position[1] = quantizeUnsigned16(p.y);
+        v.Position[2] = quantizeUnsigned16(p.z);
+        v.Padding = 0;
+        v.Normal[0] = quantizeSigned8(n.x);
+        v.Normal[1] = quantizeSigned8(n.y);
+        v.Value = quantizeUnsigned8(value);
+        v.Padding2 = 0;
+    }
+}
+
 void Model::VertexAttributes(std::vector<float> &result) const {
     for (int i = 0; i < m_Positions.size(); i++) {
         const auto &p = m_Positions[i];
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <vector>
 
@@ -7,6 +8,17 @@
 #include "pool.h"
 #include "triangle.h"
 
+// PackedVertex is a 12 byte vertex for GPU upload, decoded in the vertex shader
+struct PackedVertex {
+    uint16_t Position[3];
+    uint16_t Padding;
+    int8_t Normal[2];
+    uint8_t Value;
+    uint8_t Padding2;
+};
+
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex must be 12 bytes");
+
 class Model {
 public:
     Model(
@@ -44,6 +56,13 @@ public:
 
     void VertexAttributes(std::vector<float> &result) const;
 
+    // PackedVertexAttributes fills result with one PackedVertex per cell,
+    // quantized relative to the current bounds, which are returned in
+    // min / max so that the vertex shader can decode the positions
+    void PackedVertexAttributes(
+        std::vector<PackedVertex> &result,
+        glm::vec3 &min, glm::vec3 &max) const;
+
 private:
     void Ensure();
 